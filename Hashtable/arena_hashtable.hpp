@@ -0,0 +1,206 @@
+#ifndef ARENA_HASHTABLE_H
+#define ARENA_HASHTABLE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "hashtable.hpp"
+
+// Bump allocator for string bytes. Blocks double in size (up to 64 MB),
+// so even tens of millions of strings take a few dozen allocations, and
+// everything is freed together when the arena goes away or is cleared.
+class StringArena {
+    private:
+        static constexpr std::size_t kFirstBlock = 64 * 1024;
+        static constexpr std::size_t kMaxBlock = 64 * 1024 * 1024;
+
+        std::vector<std::unique_ptr<char[]> > blocks;
+        char* next = nullptr;
+        std::size_t remaining = 0;
+        std::size_t blockSize = kFirstBlock;
+        std::size_t bytes = 0;
+
+    public:
+        StringArena() = default;
+        StringArena(const StringArena&) = delete;
+        StringArena& operator=(const StringArena&) = delete;
+        StringArena(StringArena&&) = default;
+        StringArena& operator=(StringArena&&) = default;
+
+        // Copies text into the arena. The copy lives as long as the arena.
+        const char* store(std::string_view text){
+            if (text.size() > remaining){
+                std::size_t size = std::max(blockSize, text.size());
+                blocks.emplace_back(new char[size]);
+                next = blocks.back().get();
+                remaining = size;
+                blockSize = std::min(blockSize * 2, kMaxBlock);
+            }
+            char* copy = next;
+            std::memcpy(copy, text.data(), text.size());
+            next += text.size();
+            remaining -= text.size();
+            bytes += text.size();
+            return copy;
+        }
+
+        void clear(){
+            blocks.clear();
+            next = nullptr;
+            remaining = 0;
+            blockSize = kFirstBlock;
+            bytes = 0;
+        }
+
+        std::size_t size() const { return bytes; }
+        std::size_t blockCount() const { return blocks.size(); }
+};
+
+// A 16-byte string handle. Up to 12 bytes are stored inline; longer
+// strings keep their first 4 bytes inline next to a pointer to the full
+// text in a StringArena. Either way the length and first bytes sit in the
+// handle, so most mismatches are found without leaving the slot. Handles
+// own nothing, so they copy and destroy for free.
+class ArenaString {
+    private:
+        static constexpr std::size_t kInline = 12;
+
+        uint32_t length;
+        char bytes[kInline];  // Whole string, or a 4-byte prefix then the pointer
+
+        const char* pointer() const {
+            const char* data;
+            std::memcpy(&data, bytes + 4, sizeof(data));
+            return data;
+        }
+
+    public:
+        ArenaString(std::string_view text, StringArena& arena) : length((uint32_t)text.size()) {
+            std::memset(bytes, 0, sizeof(bytes));
+            if (text.size() <= kInline){
+                std::memcpy(bytes, text.data(), text.size());
+            } else {
+                std::memcpy(bytes, text.data(), 4);
+                const char* data = arena.store(text);
+                std::memcpy(bytes + 4, &data, sizeof(data));
+            }
+        }
+
+        // Points into the handle itself for inline strings, so the view
+        // moves with the entry; see HashTable on pointer lifetimes.
+        std::string_view view() const {
+            return length <= kInline ? std::string_view(bytes, length) : std::string_view(pointer(), length);
+        }
+
+        operator std::string_view() const { return view(); }
+
+        bool operator==(const ArenaString& other) const {
+            // Length and the first 4 bytes in one compare. Inline strings are
+            // zero-padded, so comparing the other 8 bytes settles them too.
+            if (std::memcmp(this, &other, 8) != 0){
+                return false;
+            }
+            if (length <= kInline){
+                return std::memcmp(bytes + 4, other.bytes + 4, 8) == 0;
+            }
+            return std::memcmp(pointer(), other.pointer(), length) == 0;
+        }
+
+        bool operator==(std::string_view text) const {
+            return length == text.size() && view() == text;
+        }
+};
+
+static_assert(sizeof(ArenaString) == 16, "ArenaString should stay two words");
+
+struct ArenaStringHash : WyHash {
+    using WyHash::operator();
+
+    uint64_t operator()(const ArenaString& key) const {
+        return WyHash::operator()(key.view());
+    }
+};
+
+struct ArenaStringEqual {
+    using is_transparent = void;
+
+    bool operator()(const ArenaString& a, const ArenaString& b) const { return a == b; }
+    bool operator()(const ArenaString& a, std::string_view b) const { return a == b; }
+};
+
+// A string-to-string HashTable whose keys and values live in a StringArena
+// instead of owning a std::string each. Slots hold two 16-byte handles, so
+// building the table allocates only the slot arrays and a few arena
+// blocks, and tearing it down frees those without visiting the entries.
+// Replaced values and removed entries keep their arena bytes until clear().
+class ArenaHashTable {
+    private:
+        // A key being inserted: looked up as text, and only copied into the
+        // arena when the table actually stores it.
+        struct PendingKey {
+            std::string_view text;
+            StringArena* arena;
+
+            operator std::string_view() const { return text; }
+            operator ArenaString() const { return ArenaString(text, *arena); }
+        };
+
+        struct Hash : ArenaStringHash {
+            using ArenaStringHash::operator();
+            uint64_t operator()(const PendingKey& key) const { return WyHash::operator()(key.text); }
+        };
+
+        struct Equal : ArenaStringEqual {
+            using ArenaStringEqual::operator();
+            bool operator()(const ArenaString& a, const PendingKey& b) const { return a == b.text; }
+        };
+
+        StringArena arena;
+        HashTable<ArenaString, ArenaString, Hash, Equal> table;
+
+    public:
+        explicit ArenaHashTable(int size = 0) : table(size) {}
+
+        // Adds key, or replaces its value. Returns true if the key was new.
+        bool insert(std::string_view key, std::string_view value){
+            std::pair<ArenaString*, bool> result = table.try_emplace(PendingKey{key, &arena}, value, arena);
+            if (!result.second){
+                *result.first = ArenaString(value, arena);
+            }
+            return result.second;
+        }
+
+        // The value for key. The view stays valid until the next insert or
+        // remove (short values live inside the table's slots).
+        std::optional<std::string_view> find(std::string_view key) const {
+            const ArenaString* value = table.find(key);
+            return value ? std::optional<std::string_view>(value->view()) : std::nullopt;
+        }
+
+        bool contains(std::string_view key) const { return table.contains(key); }
+
+        bool remove(std::string_view key){ return table.remove(key); }
+
+        // Drops every entry and all arena blocks at once.
+        void clear(){
+            table = HashTable<ArenaString, ArenaString, Hash, Equal>();
+            arena.clear();
+        }
+
+        // Calls f(string_view key, string_view value) for every entry.
+        template <typename F>
+        void forEach(F&& f) const {
+            table.forEach([&](const ArenaString& key, const ArenaString& value){ f(key.view(), value.view()); });
+        }
+
+        std::size_t size() const { return table.size(); }
+        std::size_t arenaBytes() const { return arena.size(); }
+        HashTableStats stats() const { return table.stats(); }
+};
+
+#endif
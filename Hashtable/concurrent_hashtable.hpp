@@ -0,0 +1,196 @@
+#ifndef CONCURRENT_HASHTABLE_H
+#define CONCURRENT_HASHTABLE_H
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <thread>
+#include <utility>
+#include "hashtable.hpp"
+
+// A HashTable split into independently locked shards for use from many
+// threads. A key's shard comes from the top bits of its hash (the shard's
+// own table uses the low bits), so the key is hashed once. Readers of a
+// shard share its lock and writers take it exclusively; operations on
+// different shards never touch the same lock or cache line, so with enough
+// shards readers and writers on different keys run in parallel.
+//
+// Values can't be handed out by pointer once the lock is dropped, so reads
+// either copy (search) or run a callback under the lock (visit, update).
+template <typename K, typename V, typename Hash = DefaultHash<K>, typename Eq = std::equal_to<>>
+class ConcurrentHashTable {
+    private:
+        using Table = HashTable<K, V, Hash, Eq>;
+
+        // Padded to a cache line so neighbouring shards' locks don't share one.
+        struct alignas(64) Shard {
+            mutable std::shared_mutex lock;
+            Table table;
+        };
+
+        std::unique_ptr<Shard[]> shards;
+        unsigned shardBits;
+        Hash hasher;
+
+        static constexpr bool kTransparent = Table::kTransparent;
+
+        Shard& shardFor(uint64_t hash) const {
+            return shards[hash >> (64 - shardBits)];
+        }
+
+        template <typename Q, typename F>
+        bool visitKey(const Q& key, F&& f) const {
+            uint64_t hash = hasher(key);
+            Shard& shard = shardFor(hash);
+            std::shared_lock<std::shared_mutex> guard(shard.lock);
+            typename Table::Entry* entry = shard.table.locate(key, hash);
+            if (!entry){
+                return false;
+            }
+            f((const V&)entry->second);
+            return true;
+        }
+
+        template <typename Q, typename F>
+        bool updateKey(const Q& key, F&& f){
+            uint64_t hash = hasher(key);
+            Shard& shard = shardFor(hash);
+            std::unique_lock<std::shared_mutex> guard(shard.lock);
+            typename Table::Entry* entry = shard.table.locate(key, hash);
+            if (!entry){
+                return false;
+            }
+            f(entry->second);
+            return true;
+        }
+
+        template <typename Q>
+        bool removeKey(const Q& key){
+            uint64_t hash = hasher(key);
+            Shard& shard = shardFor(hash);
+            std::unique_lock<std::shared_mutex> guard(shard.lock);
+            return shard.table.removeKey(key, hash);
+        }
+
+    public:
+        // shardCount is rounded up to a power of two; 0 picks four shards
+        // per hardware thread, at least 16.
+        explicit ConcurrentHashTable(std::size_t shardCount = 0){
+            if (shardCount == 0){
+                shardCount = std::max<std::size_t>(16, std::thread::hardware_concurrency() * 4);
+            }
+            shardBits = 1;
+            while (((std::size_t)1 << shardBits) < shardCount){
+                shardBits++;
+            }
+            shards.reset(new Shard[(std::size_t)1 << shardBits]);
+        }
+
+        // Adds key, or replaces its value. Returns true if the key was new.
+        bool insert(K key, V value){
+            uint64_t hash = hasher(key);
+            Shard& shard = shardFor(hash);
+            std::unique_lock<std::shared_mutex> guard(shard.lock);
+            std::pair<V*, bool> result = shard.table.tryEmplace(hash, std::move(key), std::move(value));
+            if (!result.second){
+                *result.first = std::move(value);
+            }
+            return result.second;
+        }
+
+        // Constructs the value from args if key is absent. Returns true if
+        // it was inserted.
+        template <typename Q, typename... Args>
+        bool try_emplace(Q&& key, Args&&... args){
+            if constexpr (kTransparent){
+                uint64_t hash = hasher(key);
+                Shard& shard = shardFor(hash);
+                std::unique_lock<std::shared_mutex> guard(shard.lock);
+                return shard.table.tryEmplace(hash, std::forward<Q>(key), std::forward<Args>(args)...).second;
+            } else {
+                K stored(std::forward<Q>(key));
+                uint64_t hash = hasher(stored);
+                Shard& shard = shardFor(hash);
+                std::unique_lock<std::shared_mutex> guard(shard.lock);
+                return shard.table.tryEmplace(hash, std::move(stored), std::forward<Args>(args)...).second;
+            }
+        }
+
+        // A copy of key's value, or nothing.
+        std::optional<V> search(const K& key) const {
+            std::optional<V> result;
+            visitKey(key, [&](const V& value){ result = value; });
+            return result;
+        }
+
+        template <typename Q> requires kTransparent
+        std::optional<V> search(const Q& key) const {
+            std::optional<V> result;
+            visitKey(key, [&](const V& value){ result = value; });
+            return result;
+        }
+
+        bool contains(const K& key) const {
+            return visitKey(key, [](const V&){});
+        }
+
+        template <typename Q> requires kTransparent
+        bool contains(const Q& key) const {
+            return visitKey(key, [](const V&){});
+        }
+
+        // Calls f(const V&) with key's value while holding the shard's read
+        // lock. Returns false if key is absent. f must not call back into
+        // the table.
+        template <typename F>
+        bool visit(const K& key, F&& f) const {
+            return visitKey(key, std::forward<F>(f));
+        }
+
+        template <typename Q, typename F> requires kTransparent
+        bool visit(const Q& key, F&& f) const {
+            return visitKey(key, std::forward<F>(f));
+        }
+
+        // Calls f(V&) with key's value while holding the shard's write lock,
+        // for read-modify-write updates. Returns false if key is absent.
+        template <typename F>
+        bool update(const K& key, F&& f){
+            return updateKey(key, std::forward<F>(f));
+        }
+
+        template <typename Q, typename F> requires kTransparent
+        bool update(const Q& key, F&& f){
+            return updateKey(key, std::forward<F>(f));
+        }
+
+        bool remove(const K& key){ return removeKey(key); }
+
+        template <typename Q> requires kTransparent
+        bool remove(const Q& key){ return removeKey(key); }
+
+        // Combined diagnostics for all shards, taken one shard at a time.
+        HashTableStats stats() const {
+            HashTableStats result;
+            for (std::size_t i = 0; i < ((std::size_t)1 << shardBits); i++){
+                std::shared_lock<std::shared_mutex> guard(shards[i].lock);
+                result.merge(shards[i].table.stats());
+            }
+            return result;
+        }
+
+        // Sums the shards one at a time, so it is exact only when no other
+        // thread is writing.
+        std::size_t size() const {
+            std::size_t total = 0;
+            for (std::size_t i = 0; i < ((std::size_t)1 << shardBits); i++){
+                std::shared_lock<std::shared_mutex> guard(shards[i].lock);
+                total += shards[i].table.size();
+            }
+            return total;
+        }
+};
+
+#endif
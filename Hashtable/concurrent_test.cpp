@@ -0,0 +1,74 @@
+// Checks ConcurrentHashTable under several threads. Exits non-zero with a
+// message on the first wrong result; run by ctest.
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "concurrent_hashtable.hpp"
+
+static void check(bool ok, const char* what){
+    if (!ok){
+        std::cerr << "FAIL: " << what << std::endl;
+        std::exit(1);
+    }
+}
+
+int main(){
+    const int threads = 8;
+    const int keys = 20000;
+
+    // Every thread adds 1 to every integer key: try_emplace and update must
+    // lose no increments, and the non-transparent path must not recurse.
+    ConcurrentHashTable<int, int> counts;
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++){
+        workers.emplace_back([&counts, keys]{
+            for (int key = 0; key < keys; key++){
+                if (!counts.try_emplace(key, 1)){
+                    counts.update(key, [](int& value){ value++; });
+                }
+            }
+        });
+    }
+    for (std::thread& worker : workers){
+        worker.join();
+    }
+    workers.clear();
+    check(counts.size() == (std::size_t)keys, "int table size");
+    for (int key = 0; key < keys; key++){
+        check(counts.search(key) == threads, "int count");
+    }
+
+    // Each thread owns a range of string keys: inserts, then removes the odd
+    // ones, while the others read keys that are never removed.
+    ConcurrentHashTable<std::string, int> names;
+    for (int key = 0; key < keys; key++){
+        names.insert("fixed:" + std::to_string(key), key);
+    }
+    for (int t = 0; t < threads; t++){
+        workers.emplace_back([&names, t, keys]{
+            for (int i = 0; i < keys; i++){
+                std::string key = "t" + std::to_string(t) + ":" + std::to_string(i);
+                names.insert(key, i);
+                if (i % 2){
+                    names.remove(key);
+                }
+                check(names.search(std::string_view("fixed:" + std::to_string(i))) == i, "fixed key");
+            }
+        });
+    }
+    for (std::thread& worker : workers){
+        worker.join();
+    }
+    check(names.size() == (std::size_t)keys + threads * (keys / 2), "string table size");
+    for (int t = 0; t < threads; t++){
+        for (int i = 0; i < keys; i++){
+            std::string key = "t" + std::to_string(t) + ":" + std::to_string(i);
+            check(names.contains(key) == (i % 2 == 0), "removed keys");
+        }
+    }
+
+    std::cout << "ConcurrentHashTable: ok" << std::endl;
+    return 0;
+}
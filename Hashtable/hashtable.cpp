@@ -1,70 +1,11 @@
 #include <iostream>
-#include <vector>
 #include <string>
-#include <utility>
-
-class HashTable {
-    private:
-        std::vector<std::vector<std::pair<std::string, std::string> > > table;
-        int size;
-
-        int hashFunction(std::string key){
-            int hash = 0;
-            for (int i = 0; i < key.length(); i++){
-                hash += key[i];
-            }
-            return hash % size;
-        }
-
-    public:
-        HashTable(int size){
-            this->size = size;
-            table.resize(size);
-        }
-
-        void insert(std::string key, std::string value){
-            int index = hashFunction(key);
-            table[index].push_back(std::make_pair(key, value));
-            display();
-
-        }
-
-        std::string search(std::string key){
-            int index = hashFunction(key);
-            for (int i = 0; i < table[index].size(); i++){
-                if (table[index][i].first == key){
-                    return table[index][i].second;
-                }
-            }
-            return "Not found";
-        }
-
-        void remove(std::string key){
-            int index = hashFunction(key);
-            for (int i = 0; i < table[index].size(); i++){
-                if (table[index][i].first == key){
-                    table[index].erase(table[index].begin() + i);
-                    return;
-                }
-            }
-        }
-
-        void display(){
-            for (int i = 0; i < size; i++){
-                std::cout << i;
-                for (int j = 0; j < table[i].size(); j++){
-                    std::cout << " --> " << table[i][j].first << " : " << table[i][j].second;
-                }
-                std::cout << std::endl;
-            }
-        }
-};
-
-
+#include "hashtable.hpp"
+#include "concurrent_hashtable.hpp"
 
 int main(){
 
-    HashTable ht(10);
+    HashTable<std::string, std::string> ht(10);
 
     ht.insert("John", "Doe");
     ht.insert("Jane", "Doe");
@@ -72,13 +13,13 @@ int main(){
 
     ht.display();
 
-    std::cout << "Search Alice: " << ht.search("Alice") << std::endl;
-    std::cout << "Search Bob: " << ht.search("Bob") << std::endl;
-    std::cout << "Search Eve: " << ht.search("Eve") << std::endl;
-    std::cout << "Search John: " << ht.search("John") << std::endl;
-    std::cout << "Search Jane: " << ht.search("Jane") << std::endl;
-    std::cout << "Search Charlie: " << ht.search("Charlie") << std::endl;
-    std::cout << "Search Dave: " << ht.search("Dave") << std::endl;
+    std::cout << "Search Alice: " << ht.search("Alice").value_or("Not found") << std::endl;
+    std::cout << "Search Bob: " << ht.search("Bob").value_or("Not found") << std::endl;
+    std::cout << "Search Eve: " << ht.search("Eve").value_or("Not found") << std::endl;
+    std::cout << "Search John: " << ht.search("John").value_or("Not found") << std::endl;
+    std::cout << "Search Jane: " << ht.search("Jane").value_or("Not found") << std::endl;
+    std::cout << "Search Charlie: " << ht.search("Charlie").value_or("Not found") << std::endl;
+    std::cout << "Search Dave: " << ht.search("Dave").value_or("Not found") << std::endl;
 
     ht.remove("John");
     ht.remove("Jane");
@@ -86,8 +27,21 @@ int main(){
 
     ht.display();
 
+    HashTableStats stats = ht.stats();
+    std::cout << "Entries: " << stats.size << ", slots: " << stats.capacity
+              << ", load factor: " << stats.loadFactor
+              << ", max probe length: " << stats.maxProbeLength << std::endl;
+
+    // Integer keys go through DefaultHash and the non-transparent path.
+    ConcurrentHashTable<int, int> counts;
+    counts.try_emplace(5, 6);
+    counts.try_emplace(5, 7);
+    counts.update(5, [](int& value){ value++; });
+    std::cout << "Count of 5: " << counts.search(5).value_or(0)
+              << ", entries: " << counts.size() << std::endl;
+
     return 0;
 
 
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,657 @@
+#ifndef HASHTABLE_H
+#define HASHTABLE_H
+
+#include <iostream>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <tuple>
+#include <memory>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <functional>
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// wyhash: 64-bit multiply-and-fold mixing over 8-byte reads. Every byte and
+// its position affect the result, unlike a character sum. Transparent, so
+// a std::string table can be searched with a string_view or a literal
+// without building a std::string.
+struct WyHash {
+    using is_transparent = void;
+
+    static uint64_t mix(uint64_t a, uint64_t b){
+        __uint128_t product = (__uint128_t)a * b;
+        return (uint64_t)product ^ (uint64_t)(product >> 64);
+    }
+
+    static uint64_t read64(const unsigned char* p){
+        uint64_t value;
+        std::memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    static uint64_t read32(const unsigned char* p){
+        uint32_t value;
+        std::memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    static uint64_t hashBytes(const void* data, std::size_t length){
+        const uint64_t p0 = 0xa0761d6478bd642full, p1 = 0xe7037ed1a0b428dbull;
+        const uint64_t p2 = 0x8ebc6af09c88c6e3ull, p3 = 0x589965cc75374cc3ull;
+        const unsigned char* p = (const unsigned char*)data;
+        uint64_t seed = mix(p0, p1);
+        uint64_t a, b;
+        if (length <= 16){
+            if (length >= 4){
+                std::size_t middle = (length >> 3) << 2;
+                a = (read32(p) << 32) | read32(p + middle);
+                b = (read32(p + length - 4) << 32) | read32(p + length - 4 - middle);
+            } else if (length > 0){
+                a = ((uint64_t)p[0] << 16) | ((uint64_t)p[length >> 1] << 8) | p[length - 1];
+                b = 0;
+            } else {
+                a = b = 0;
+            }
+        } else {
+            std::size_t i = length;
+            if (i > 48){
+                uint64_t seed1 = seed, seed2 = seed;
+                do {
+                    seed = mix(read64(p) ^ p1, read64(p + 8) ^ seed);
+                    seed1 = mix(read64(p + 16) ^ p2, read64(p + 24) ^ seed1);
+                    seed2 = mix(read64(p + 32) ^ p3, read64(p + 40) ^ seed2);
+                    p += 48;
+                    i -= 48;
+                } while (i > 48);
+                seed ^= seed1 ^ seed2;
+            }
+            while (i > 16){
+                seed = mix(read64(p) ^ p1, read64(p + 8) ^ seed);
+                p += 16;
+                i -= 16;
+            }
+            a = read64(p + i - 16);
+            b = read64(p + i - 8);
+        }
+        return mix(p1 ^ length, mix(a ^ p1, b ^ seed));
+    }
+
+    uint64_t operator()(std::string_view key) const {
+        return hashBytes(key.data(), key.size());
+    }
+};
+
+// Default hash: wyhash for strings, and for anything else std::hash with
+// its result mixed, since std::hash of an integer is often the integer
+// itself and the table takes its control tag from the low bits.
+template <typename K>
+struct DefaultHash {
+    uint64_t operator()(const K& key) const {
+        return WyHash::mix((uint64_t)std::hash<K>{}(key) ^ 0xa0761d6478bd642full, 0xe7037ed1a0b428dbull);
+    }
+};
+
+template <>
+struct DefaultHash<std::string> : WyHash {};
+
+template <>
+struct DefaultHash<std::string_view> : WyHash {};
+
+// Compares 16 control bytes at once. Shared by HashTable and the
+// memory-mapped HashTableSnapshot, which use the same control codes.
+struct ControlGroup {
+    static constexpr std::size_t kSize = 16;
+    static constexpr int8_t kEmpty = -128;   // 0b10000000
+    static constexpr int8_t kDeleted = -2;   // 0b11111110
+
+    // Bit i is set if bytes[i] equals value.
+    static uint32_t match(const int8_t* bytes, int8_t value){
+#if defined(__SSE2__)
+        __m128i codes = _mm_loadu_si128((const __m128i*)bytes);
+        return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(codes, _mm_set1_epi8(value)));
+#else
+        uint32_t mask = 0;
+        for (std::size_t i = 0; i < kSize; i++){
+            if (bytes[i] == value){
+                mask |= 1u << i;
+            }
+        }
+        return mask;
+#endif
+    }
+
+    // Free slots (empty or deleted) have the top bit set.
+    static uint32_t matchFree(const int8_t* bytes){
+#if defined(__SSE2__)
+        return (uint32_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)bytes));
+#else
+        uint32_t mask = 0;
+        for (std::size_t i = 0; i < kSize; i++){
+            if (bytes[i] < 0){
+                mask |= 1u << i;
+            }
+        }
+        return mask;
+#endif
+    }
+};
+
+template <typename K, typename V, typename Hash, typename Eq>
+class ConcurrentHashTable;
+
+// A snapshot of how a table's entries are spread, from HashTable::stats.
+// Probe lengths count the 16-slot groups a lookup visits to reach an
+// entry: 1 means it sits in its home group.
+struct HashTableStats {
+    std::size_t size = 0;
+    std::size_t capacity = 0;     // Slots across both tables while resizing
+    std::size_t tombstones = 0;
+    double loadFactor = 0;        // size / capacity
+    std::size_t maxProbeLength = 0;
+    double meanProbeLength = 0;
+    bool resizing = false;
+    std::vector<std::size_t> groupOccupancy;  // [n]: groups holding n entries (0-16)
+    std::vector<std::size_t> probeLengths;    // [n]: entries with probe length n
+
+    // Folds another table's numbers in, e.g. to sum the shards of a
+    // ConcurrentHashTable.
+    void merge(const HashTableStats& other){
+        double probes = meanProbeLength * size + other.meanProbeLength * other.size;
+        size += other.size;
+        capacity += other.capacity;
+        tombstones += other.tombstones;
+        loadFactor = capacity ? (double)size / capacity : 0;
+        maxProbeLength = std::max(maxProbeLength, other.maxProbeLength);
+        meanProbeLength = size ? probes / size : 0;
+        resizing = resizing || other.resizing;
+        if (groupOccupancy.size() < other.groupOccupancy.size()){
+            groupOccupancy.resize(other.groupOccupancy.size());
+        }
+        for (std::size_t i = 0; i < other.groupOccupancy.size(); i++){
+            groupOccupancy[i] += other.groupOccupancy[i];
+        }
+        if (probeLengths.size() < other.probeLengths.size()){
+            probeLengths.resize(other.probeLengths.size());
+        }
+        for (std::size_t i = 0; i < other.probeLengths.size(); i++){
+            probeLengths[i] += other.probeLengths[i];
+        }
+    }
+};
+
+// Open addressing in the style of Swiss tables. Every slot has a one-byte
+// control code: empty, deleted, or the low 7 bits of the key's hash. Slots
+// are probed in groups of 16, and with SSE2 a whole group's control bytes
+// are compared against the hash in one instruction, so a lookup usually
+// touches one control line and one slot.
+//
+// When both Hash and Eq declare is_transparent, lookups accept anything
+// they can hash and compare (a string_view or literal for string keys), so
+// finding a key allocates nothing. Pointers to values stay valid until the
+// next insert, emplace or remove, which may move entries while growing.
+template <typename K, typename V, typename Hash = DefaultHash<K>, typename Eq = std::equal_to<>>
+class HashTable {
+    private:
+        friend class ConcurrentHashTable<K, V, Hash, Eq>;
+
+        using Entry = std::pair<K, V>;
+
+        static constexpr int8_t kEmpty = ControlGroup::kEmpty;
+        static constexpr int8_t kDeleted = ControlGroup::kDeleted;
+        static constexpr std::size_t kGroupSize = ControlGroup::kSize;
+        static constexpr bool kTransparent = requires {
+            typename Hash::is_transparent;
+            typename Eq::is_transparent;
+        };
+
+        // Uninitialized room for one entry; constructed only while full.
+        struct Slot {
+            alignas(Entry) unsigned char bytes[sizeof(Entry)];
+
+            Entry* entry(){ return std::launder(reinterpret_cast<Entry*>(bytes)); }
+            const Entry* entry() const { return std::launder(reinterpret_cast<const Entry*>(bytes)); }
+        };
+
+        // One slot array and its control bytes. While the table is growing
+        // there are two of these: the new one and the one being drained.
+        struct Table {
+            std::unique_ptr<int8_t[]> control;
+            std::unique_ptr<Slot[]> slots;
+            std::size_t capacity = 0;  // Power of two, a multiple of kGroupSize
+            std::size_t count = 0;     // Live entries
+            std::size_t used = 0;      // Live entries plus tombstones
+
+            Table() = default;
+            Table(const Table&) = delete;
+            Table& operator=(const Table&) = delete;
+
+            Table(Table&& other) noexcept { *this = std::move(other); }
+
+            Table& operator=(Table&& other) noexcept {
+                if (this != &other){
+                    release();
+                    control = std::move(other.control);
+                    slots = std::move(other.slots);
+                    capacity = std::exchange(other.capacity, 0);
+                    count = std::exchange(other.count, 0);
+                    used = std::exchange(other.used, 0);
+                }
+                return *this;
+            }
+
+            ~Table(){ release(); }
+
+            void allocate(std::size_t newCapacity){
+                release();
+                capacity = newCapacity;
+                control.reset(new int8_t[capacity]);
+                std::memset(control.get(), (unsigned char)kEmpty, capacity);
+                slots.reset(new Slot[capacity]);
+            }
+
+            // Entries that need no destructor (arena strings, plain numbers)
+            // are dropped with the slot array instead of one at a time.
+            void release(){
+                if constexpr (!std::is_trivially_destructible_v<Entry>){
+                    for (std::size_t i = 0; count > 0 && i < capacity; i++){
+                        if (control[i] >= 0){
+                            slots[i].entry()->~Entry();
+                            count--;
+                        }
+                    }
+                }
+                control.reset();
+                slots.reset();
+                capacity = count = used = 0;
+            }
+
+            uint32_t matchGroup(std::size_t group, int8_t value) const {
+                return ControlGroup::match(control.get() + group, value);
+            }
+
+            uint32_t matchFree(std::size_t group) const {
+                return ControlGroup::matchFree(control.get() + group);
+            }
+
+            // Groups are visited in triangular order (+1, +2, +3 groups...),
+            // which reaches every group when the group count is a power of
+            // two. Returns the slot holding key, or capacity if there is none.
+            template <typename Q>
+            std::size_t find(const Q& key, uint64_t hash, const Eq& eq) const {
+                if (count == 0){
+                    return capacity;
+                }
+                int8_t tag = (int8_t)(hash & 0x7f);
+                std::size_t mask = capacity - 1;
+                std::size_t group = (hash >> 7) & mask & ~(kGroupSize - 1);
+                for (std::size_t step = kGroupSize; ; step += kGroupSize){
+                    for (uint32_t hits = matchGroup(group, tag); hits; hits &= hits - 1){
+                        std::size_t slot = group + __builtin_ctz(hits);
+                        if (eq(slots[slot].entry()->first, key)){
+                            return slot;
+                        }
+                    }
+                    if (matchGroup(group, kEmpty)){
+                        return capacity;
+                    }
+                    group = (group + step) & mask;
+                }
+            }
+
+            // Constructs an entry known not to be present. The caller keeps
+            // the table below 7/8 full, so the probe always finds a free slot.
+            template <typename... Args>
+            Entry* place(uint64_t hash, Args&&... args){
+                std::size_t mask = capacity - 1;
+                std::size_t group = (hash >> 7) & mask & ~(kGroupSize - 1);
+                uint32_t free;
+                for (std::size_t step = kGroupSize; !(free = matchFree(group)); step += kGroupSize){
+                    group = (group + step) & mask;
+                }
+                std::size_t slot = group + __builtin_ctz(free);
+                Entry* entry = ::new (slots[slot].bytes) Entry(std::forward<Args>(args)...);
+                if (control[slot] == kEmpty){
+                    used++;
+                }
+                control[slot] = (int8_t)(hash & 0x7f);
+                count++;
+                return entry;
+            }
+
+            // A slot in a group that still has an empty slot can go straight
+            // back to empty: no probe sequence continues past that group.
+            // Otherwise it becomes a tombstone so later entries stay reachable.
+            void erase(std::size_t slot){
+                std::size_t group = slot & ~(kGroupSize - 1);
+                if (matchGroup(group, kEmpty)){
+                    control[slot] = kEmpty;
+                    used--;
+                } else {
+                    control[slot] = kDeleted;
+                }
+                slots[slot].entry()->~Entry();
+                count--;
+            }
+        };
+
+        // Groups of the old table moved per insert or remove while growing.
+        // One group per operation drains the old table well before the new
+        // one could fill up.
+        static constexpr std::size_t kMigrateGroups = 1;
+
+        Table current;
+        Table previous;         // Being drained into current; empty otherwise
+        std::size_t migrated;   // Slots of previous already moved
+        Hash hasher;
+        Eq equal;
+
+        bool resizing() const {
+            return previous.capacity != 0;
+        }
+
+        // Moves up to `groups` groups of entries from the old table into
+        // the new one, and drops the old table once it is empty.
+        void migrate(std::size_t groups){
+            std::size_t end = migrated + groups * kGroupSize;
+            if (end > previous.capacity){
+                end = previous.capacity;
+            }
+            for (; migrated < end; migrated++){
+                if (previous.control[migrated] >= 0){
+                    Entry* entry = previous.slots[migrated].entry();
+                    current.place(hasher(entry->first), std::move(*entry));
+                    entry->~Entry();
+                    previous.control[migrated] = kDeleted;
+                    previous.count--;
+                }
+            }
+            if (migrated == previous.capacity){
+                previous.release();
+            }
+        }
+
+        // Keeps at most 7/8 of the slots in use (tombstones included). When
+        // the limit is hit a new table is allocated (twice the size, or the
+        // same size if tombstones rather than entries are filling it) and
+        // the old one is moved over a group at a time by later operations,
+        // so no single insert pays for rehashing the whole table.
+        void reserveOne(){
+            if ((current.used + 1) * 8 <= current.capacity * 7){
+                return;
+            }
+            if (resizing()){
+                migrate(previous.capacity);  // Not expected; finish the last resize first
+            }
+            std::size_t capacity = current.capacity ? current.capacity : kGroupSize;
+            if ((current.count + 1) * 16 > capacity * 7){
+                capacity *= 2;
+            }
+            previous = std::move(current);
+            current.allocate(capacity);
+            migrated = 0;
+        }
+
+        // Finds key in whichever table holds it; nullptr if neither does.
+        template <typename Q>
+        Entry* locate(const Q& key, uint64_t hash) const {
+            std::size_t slot = current.find(key, hash, equal);
+            if (slot != current.capacity){
+                return current.slots[slot].entry();
+            }
+            if (resizing()){
+                slot = previous.find(key, hash, equal);
+                if (slot != previous.capacity){
+                    return previous.slots[slot].entry();
+                }
+            }
+            return nullptr;
+        }
+
+        // Adds an entry for key if there is none. Args construct the value.
+        // An existing entry still in the old table is moved to the new one.
+        // The private members take the key's hash from the caller, so a
+        // ConcurrentHashTable hashes once to pick a shard and the table.
+        template <typename Q, typename... Args>
+        std::pair<V*, bool> tryEmplace(uint64_t hash, Q&& key, Args&&... args){
+            if (resizing()){
+                migrate(kMigrateGroups);
+            }
+            std::size_t slot = current.find(key, hash, equal);
+            if (slot != current.capacity){
+                return std::make_pair(&current.slots[slot].entry()->second, false);
+            }
+            if (resizing()){
+                slot = previous.find(key, hash, equal);
+                if (slot != previous.capacity){
+                    // Move it across now instead of waiting for the sweep,
+                    // so the next lookup finds it in the first table.
+                    Entry* entry = current.place(hash, std::move(*previous.slots[slot].entry()));
+                    previous.erase(slot);
+                    return std::make_pair(&entry->second, false);
+                }
+            }
+            reserveOne();
+            Entry* entry = current.place(hash, std::piecewise_construct,
+                                         std::forward_as_tuple(std::forward<Q>(key)),
+                                         std::forward_as_tuple(std::forward<Args>(args)...));
+            return std::make_pair(&entry->second, true);
+        }
+
+        template <typename Q>
+        bool removeKey(const Q& key, uint64_t hash){
+            if (resizing()){
+                migrate(kMigrateGroups);
+            }
+            for (Table* table : {&current, &previous}){
+                if (table->capacity == 0){
+                    continue;
+                }
+                std::size_t slot = table->find(key, hash, equal);
+                if (slot != table->capacity){
+                    table->erase(slot);
+                    return true;
+                }
+            }
+            return false;
+        }
+
+    public:
+        HashTable(int size = 0){
+            std::size_t wanted = kGroupSize;
+            while (wanted * 7 < (std::size_t)(size > 0 ? size : 0) * 8){
+                wanted *= 2;
+            }
+            current.allocate(wanted);
+            migrated = 0;
+        }
+
+        HashTable(const HashTable&) = delete;
+        HashTable& operator=(const HashTable&) = delete;
+        HashTable(HashTable&&) = default;
+        HashTable& operator=(HashTable&&) = default;
+
+        // Adds key, or replaces its value if it is already present. Returns
+        // true if the key was new. Both arguments are moved into the table.
+        bool insert(K key, V value){
+            uint64_t hash = hasher(key);
+            std::pair<V*, bool> result = tryEmplace(hash, std::move(key), std::move(value));
+            if (!result.second){
+                *result.first = std::move(value);
+            }
+            return result.second;
+        }
+
+        // Like std::unordered_map::try_emplace: does nothing if key is
+        // present; otherwise constructs the value from args. The key is
+        // only converted to K when it is actually stored.
+        template <typename Q, typename... Args>
+        std::pair<V*, bool> try_emplace(Q&& key, Args&&... args){
+            if constexpr (kTransparent){
+                uint64_t hash = hasher(key);
+                return tryEmplace(hash, std::forward<Q>(key), std::forward<Args>(args)...);
+            } else {
+                K stored(std::forward<Q>(key));
+                uint64_t hash = hasher(stored);
+                return tryEmplace(hash, std::move(stored), std::forward<Args>(args)...);
+            }
+        }
+
+        // Builds the entry from args, then keeps it only if the key is new.
+        template <typename... Args>
+        std::pair<V*, bool> emplace(Args&&... args){
+            Entry entry(std::forward<Args>(args)...);
+            uint64_t hash = hasher(entry.first);
+            return tryEmplace(hash, std::move(entry.first), std::move(entry.second));
+        }
+
+        V* find(const K& key){
+            Entry* entry = locate(key, hasher(key));
+            return entry ? &entry->second : nullptr;
+        }
+
+        const V* find(const K& key) const {
+            Entry* entry = locate(key, hasher(key));
+            return entry ? &entry->second : nullptr;
+        }
+
+        template <typename Q> requires kTransparent
+        V* find(const Q& key){
+            Entry* entry = locate(key, hasher(key));
+            return entry ? &entry->second : nullptr;
+        }
+
+        template <typename Q> requires kTransparent
+        const V* find(const Q& key) const {
+            Entry* entry = locate(key, hasher(key));
+            return entry ? &entry->second : nullptr;
+        }
+
+        bool contains(const K& key) const { return find(key) != nullptr; }
+
+        template <typename Q> requires kTransparent
+        bool contains(const Q& key) const { return find(key) != nullptr; }
+
+        V& at(const K& key){
+            V* value = find(key);
+            if (!value){
+                throw std::out_of_range("HashTable::at: key not found");
+            }
+            return *value;
+        }
+
+        template <typename Q> requires kTransparent
+        V& at(const Q& key){
+            V* value = find(key);
+            if (!value){
+                throw std::out_of_range("HashTable::at: key not found");
+            }
+            return *value;
+        }
+
+        // A copy of the value, or nothing. Use find to avoid the copy.
+        std::optional<V> search(const K& key) const {
+            const V* value = find(key);
+            return value ? std::optional<V>(*value) : std::nullopt;
+        }
+
+        template <typename Q> requires kTransparent
+        std::optional<V> search(const Q& key) const {
+            const V* value = find(key);
+            return value ? std::optional<V>(*value) : std::nullopt;
+        }
+
+        // Returns true if key was present.
+        bool remove(const K& key){ return removeKey(key, hasher(key)); }
+
+        template <typename Q> requires kTransparent
+        bool remove(const Q& key){ return removeKey(key, hasher(key)); }
+
+        std::size_t size() const {
+            return current.count + previous.count;
+        }
+
+        bool empty() const {
+            return size() == 0;
+        }
+
+        // Calls f(key, value) for every entry, in no particular order. f
+        // must not insert into or remove from the table.
+        template <typename F>
+        void forEach(F&& f) const {
+            for (const Table* table : {&previous, &current}){
+                for (std::size_t i = 0; i < table->capacity; i++){
+                    if (table->control[i] >= 0){
+                        const Entry* entry = table->slots[i].entry();
+                        f(entry->first, entry->second);
+                    }
+                }
+            }
+        }
+
+        // Walks every slot, so this is for diagnostics, not the hot path.
+        HashTableStats stats() const {
+            HashTableStats result;
+            result.groupOccupancy.assign(kGroupSize + 1, 0);
+            result.resizing = resizing();
+            double probes = 0;
+            for (const Table* table : {&previous, &current}){
+                result.capacity += table->capacity;
+                std::size_t mask = table->capacity - 1;
+                for (std::size_t group = 0; group < table->capacity; group += kGroupSize){
+                    std::size_t live = 0;
+                    for (std::size_t i = group; i < group + kGroupSize; i++){
+                        if (table->control[i] == kDeleted){
+                            result.tombstones++;
+                        }
+                        if (table->control[i] < 0){
+                            continue;
+                        }
+                        live++;
+                        // Replay the probe sequence from the key's home group.
+                        uint64_t hash = hasher(table->slots[i].entry()->first);
+                        std::size_t probe = (hash >> 7) & mask & ~(kGroupSize - 1);
+                        std::size_t length = 1;
+                        for (std::size_t step = kGroupSize; probe != group; step += kGroupSize){
+                            probe = (probe + step) & mask;
+                            length++;
+                        }
+                        if (result.probeLengths.size() <= length){
+                            result.probeLengths.resize(length + 1);
+                        }
+                        result.probeLengths[length]++;
+                        result.maxProbeLength = std::max(result.maxProbeLength, length);
+                        probes += length;
+                    }
+                    result.groupOccupancy[live]++;
+                }
+            }
+            result.size = size();
+            result.loadFactor = result.capacity ? (double)result.size / result.capacity : 0;
+            result.meanProbeLength = result.size ? probes / result.size : 0;
+            return result;
+        }
+
+        // Lists every entry with its slot number. Only writes when asked to.
+        void display(std::ostream& out = std::cout) const {
+            for (const Table* table : {&previous, &current}){
+                for (std::size_t i = 0; i < table->capacity; i++){
+                    if (table->control[i] >= 0){
+                        const Entry* entry = table->slots[i].entry();
+                        out << i << " --> " << entry->first << " : " << entry->second << std::endl;
+                    }
+                }
+            }
+        }
+};
+
+#endif
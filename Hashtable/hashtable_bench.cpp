@@ -0,0 +1,386 @@
+// Benchmarks for HashTable, side by side with std::unordered_map.
+//
+// Every operation (insert, lookup hit, lookup miss, erase) runs for each
+// key distribution at three sizes: small enough for L1/L2, about L3, and
+// well past the caches. Throughput is Google Benchmark's items/s. After the
+// timed loop each benchmark times a sample of single operations and adds
+// p50/p99/p99.9/max latency counters, which is where resize pauses show up.
+//
+// The hash_quality benchmarks don't time anything. They hash a key set and
+// report how evenly the hashes spread, compared with an ideal random hash,
+// and how long HashTable's probes get with that hash. Run just those with
+// --benchmark_filter=hash_quality. Pass --benchmark_out=<file>
+// --benchmark_out_format=json to keep results for comparison.
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "hashtable.hpp"
+
+// Key distributions. make(count, seed) returns count distinct keys.
+
+// "user:0", "user:1", ...: short, similar strings, all within the
+// small-string buffer.
+struct SequentialStrings {
+    static constexpr const char* kName = "sequential_strings";
+
+    static std::vector<std::string> make(std::size_t count, uint64_t){
+        std::vector<std::string> keys;
+        keys.reserve(count);
+        for (std::size_t i = 0; i < count; i++){
+            keys.push_back("user:" + std::to_string(i));
+        }
+        return keys;
+    }
+};
+
+// Random letters and digits of a fixed length.
+template <std::size_t Length>
+struct RandomStrings {
+    static constexpr const char* kName = Length <= 8 ? "random_strings_8" : Length <= 32 ? "random_strings_32" : "random_strings_128";
+
+    static std::vector<std::string> make(std::size_t count, uint64_t seed){
+        static const char alphabet[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+        std::mt19937_64 rng(seed);
+        std::vector<std::string> keys(count, std::string(Length, ' '));
+        for (std::string& key : keys){
+            for (char& c : key){
+                c = alphabet[rng() % (sizeof(alphabet) - 1)];
+            }
+        }
+        // Even 8 characters give 2^47 keys; drop the odd repeat anyway.
+        std::sort(keys.begin(), keys.end());
+        keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+        while (keys.size() < count){
+            keys.push_back(keys.back());
+            keys.back()[0] = keys.back()[0] == 'z' ? 'A' : 'z';
+            keys.back() += std::to_string(keys.size());
+        }
+        std::shuffle(keys.begin(), keys.end(), rng);
+        return keys;
+    }
+};
+
+// 0, 1, 2, ...
+struct SequentialInts {
+    static constexpr const char* kName = "sequential_ints";
+
+    static std::vector<uint64_t> make(std::size_t count, uint64_t){
+        std::vector<uint64_t> keys(count);
+        for (std::size_t i = 0; i < count; i++){
+            keys[i] = i;
+        }
+        return keys;
+    }
+};
+
+// Multiples of 4096, like page-aligned addresses: the low 12 bits are
+// always zero.
+struct StridedInts {
+    static constexpr const char* kName = "strided_ints";
+
+    static std::vector<uint64_t> make(std::size_t count, uint64_t){
+        std::vector<uint64_t> keys(count);
+        for (std::size_t i = 0; i < count; i++){
+            keys[i] = (uint64_t)i << 12;
+        }
+        return keys;
+    }
+};
+
+// The tables under test, behind the same four calls.
+
+template <typename K>
+struct HashTableMap {
+    static constexpr const char* kName = "HashTable";
+
+    HashTable<K, uint64_t> table;
+
+    void insert(const K& key, uint64_t value){ table.insert(key, value); }
+    bool contains(const K& key) const { return table.contains(key); }
+    bool erase(const K& key){ return table.remove(key); }
+    std::size_t size() const { return table.size(); }
+};
+
+template <typename K>
+struct StdMap {
+    static constexpr const char* kName = "unordered_map";
+
+    std::unordered_map<K, uint64_t> map;
+
+    void insert(const K& key, uint64_t value){ map.insert_or_assign(key, value); }
+    bool contains(const K& key) const { return map.find(key) != map.end(); }
+    bool erase(const K& key){ return map.erase(key) == 1; }
+    std::size_t size() const { return map.size(); }
+};
+
+// Hashes compared by the quality report. HashTable's own defaults are
+// WyHash (strings) and DefaultHash (everything else).
+
+// The table's original hash: the sum of the character codes.
+struct CharSumHash {
+    static constexpr const char* kName = "char_sum";
+
+    uint64_t operator()(const std::string& key) const {
+        uint64_t sum = 0;
+        for (unsigned char c : key){
+            sum += c;
+        }
+        return sum;
+    }
+};
+
+struct WyHashNamed : WyHash {
+    static constexpr const char* kName = "wyhash";
+};
+
+// std::hash as is. For integers in libstdc++ this returns the integer.
+template <typename K>
+struct StdHash {
+    static constexpr const char* kName = "std_hash";
+
+    uint64_t operator()(const K& key) const { return std::hash<K>{}(key); }
+};
+
+template <typename K>
+struct DefaultHashNamed : DefaultHash<K> {
+    static constexpr const char* kName = "default_hash";
+};
+
+// Times op(i) once for each i < count and records latency percentiles in
+// nanoseconds. The cost of reading the clock is subtracted, so very fast
+// operations may round down to zero at p50.
+template <typename F>
+static void recordLatencies(benchmark::State& state, std::size_t count, F&& op){
+    using Clock = std::chrono::steady_clock;
+    int64_t overhead = INT64_MAX;
+    for (int i = 0; i < 1000; i++){
+        Clock::time_point start = Clock::now();
+        overhead = std::min<int64_t>(overhead, (Clock::now() - start).count());
+    }
+    std::vector<int64_t> samples(count);
+    for (std::size_t i = 0; i < count; i++){
+        Clock::time_point start = Clock::now();
+        op(i);
+        samples[i] = std::max<int64_t>(0, std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count() - overhead);
+    }
+    std::sort(samples.begin(), samples.end());
+    auto percentile = [&](double p){ return (double)samples[std::min(count - 1, (std::size_t)(p * count))]; };
+    state.counters["p50_ns"] = percentile(0.50);
+    state.counters["p99_ns"] = percentile(0.99);
+    state.counters["p999_ns"] = percentile(0.999);
+    state.counters["max_ns"] = (double)samples.back();
+}
+
+// Single-operation latencies are sampled over at most this many calls.
+static constexpr std::size_t kLatencySamples = 200000;
+
+template <typename Map, typename Keys>
+static void BM_Insert(benchmark::State& state){
+    std::size_t count = state.range(0);
+    auto keys = Keys::make(count, 1);
+    for (auto _ : state){
+        auto map = std::make_unique<Map>();
+        for (std::size_t i = 0; i < count; i++){
+            map->insert(keys[i], i);
+        }
+        benchmark::DoNotOptimize(map->size());
+        state.PauseTiming();
+        map.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+
+    // Inserting into one growing table, so every resize is in the sample.
+    auto map = std::make_unique<Map>();
+    recordLatencies(state, count, [&](std::size_t i){ map->insert(keys[i], i); });
+}
+
+// Looks keys up in random order from a table holding the first count keys.
+// Misses use keys from the same distribution that were never inserted.
+template <typename Map, typename Keys>
+static void lookupBenchmark(benchmark::State& state, bool hits){
+    std::size_t count = state.range(0);
+    auto keys = Keys::make(count * 2, 1);
+    Map map;
+    for (std::size_t i = 0; i < count; i++){
+        map.insert(keys[i], i);
+    }
+    std::vector<typename decltype(keys)::value_type> probes(keys.begin() + (hits ? 0 : count), keys.begin() + (hits ? count : count * 2));
+    std::shuffle(probes.begin(), probes.end(), std::mt19937_64(2));
+
+    std::size_t next = 0, found = 0;
+    for (auto _ : state){
+        found += map.contains(probes[next]);
+        if (++next == count){
+            next = 0;
+        }
+    }
+    benchmark::DoNotOptimize(found);
+    state.SetItemsProcessed(state.iterations());
+
+    recordLatencies(state, std::min(count, kLatencySamples), [&](std::size_t i){
+        benchmark::DoNotOptimize(map.contains(probes[i]));
+    });
+}
+
+template <typename Map, typename Keys>
+static void BM_LookupHit(benchmark::State& state){
+    lookupBenchmark<Map, Keys>(state, true);
+}
+
+template <typename Map, typename Keys>
+static void BM_LookupMiss(benchmark::State& state){
+    lookupBenchmark<Map, Keys>(state, false);
+}
+
+// Erases every key, in random order, from a full table.
+template <typename Map, typename Keys>
+static void BM_Erase(benchmark::State& state){
+    std::size_t count = state.range(0);
+    auto keys = Keys::make(count, 1);
+    auto order = keys;
+    std::shuffle(order.begin(), order.end(), std::mt19937_64(2));
+    for (auto _ : state){
+        state.PauseTiming();
+        auto map = std::make_unique<Map>();
+        for (std::size_t i = 0; i < count; i++){
+            map->insert(keys[i], i);
+        }
+        state.ResumeTiming();
+        for (std::size_t i = 0; i < count; i++){
+            map->erase(order[i]);
+        }
+        benchmark::DoNotOptimize(map->size());
+        state.PauseTiming();
+        map.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+
+    auto map = std::make_unique<Map>();
+    for (std::size_t i = 0; i < count; i++){
+        map->insert(keys[i], i);
+    }
+    recordLatencies(state, count, [&](std::size_t i){ map->erase(order[i]); });
+}
+
+// How well Hash spreads Keys. Hashes are bucketed the way HashTable places
+// them: bits 7 and up pick the home slot (in a power-of-two table of at
+// least count slots) and the low 7 bits are the control tag.
+//   bucket_chi2      chi-squared of bucket counts / degrees of freedom; about 1 for a random hash
+//   bucket_max       most keys in one bucket
+//   bucket_collisions  keys sharing a bucket with an earlier key, relative to a random hash (1.0 = as good)
+//   tag_chi2         like bucket_chi2, over the 128 tags
+//   hash_collisions  pairs of keys with the same full 64-bit hash
+//   max_probe, mean_probe  groups a HashTable using Hash visits to reach a key
+template <typename Hash, typename Keys>
+static void BM_HashQuality(benchmark::State& state){
+    std::size_t count = state.range(0);
+    auto keys = Keys::make(count, 1);
+    Hash hash;
+    for (auto _ : state){
+        std::vector<uint64_t> hashes(count);
+        for (std::size_t i = 0; i < count; i++){
+            hashes[i] = hash(keys[i]);
+        }
+
+        std::size_t buckets = 1;
+        while (buckets < count){
+            buckets *= 2;
+        }
+        std::vector<uint32_t> bucketCounts(buckets), tagCounts(128);
+        for (uint64_t h : hashes){
+            bucketCounts[(h >> 7) & (buckets - 1)]++;
+            tagCounts[h & 0x7f]++;
+        }
+        auto chi2 = [](const std::vector<uint32_t>& counts, double expected){
+            double sum = 0;
+            for (uint32_t c : counts){
+                sum += (c - expected) * (c - expected) / expected;
+            }
+            return sum / (counts.size() - 1);
+        };
+        double load = (double)count / buckets;
+        std::size_t occupied = buckets - std::count(bucketCounts.begin(), bucketCounts.end(), 0u);
+        double expectedCollisions = buckets * (load - 1 + std::exp(-load));
+        state.counters["bucket_chi2"] = chi2(bucketCounts, load);
+        state.counters["bucket_max"] = *std::max_element(bucketCounts.begin(), bucketCounts.end());
+        state.counters["bucket_collisions"] = (count - occupied) / expectedCollisions;
+        state.counters["tag_chi2"] = chi2(tagCounts, count / 128.0);
+
+        std::sort(hashes.begin(), hashes.end());
+        std::size_t duplicates = 0;
+        for (std::size_t i = 1; i < count; i++){
+            duplicates += hashes[i] == hashes[i - 1];
+        }
+        state.counters["hash_collisions"] = duplicates;
+
+        HashTable<typename decltype(keys)::value_type, uint64_t, Hash> table;
+        for (std::size_t i = 0; i < count; i++){
+            table.insert(keys[i], i);
+        }
+        HashTableStats stats = table.stats();
+        state.counters["max_probe"] = stats.maxProbeLength;
+        state.counters["mean_probe"] = stats.meanProbeLength;
+    }
+}
+
+#define BENCH_SIZES ->Arg(1000)->Arg(100000)->Arg(1000000)
+
+template <typename Map, typename Keys>
+static void registerOperations(){
+    std::string suffix = std::string("/") + Map::kName + "/" + Keys::kName;
+    benchmark::RegisterBenchmark(("insert" + suffix).c_str(), BM_Insert<Map, Keys>) BENCH_SIZES->Unit(benchmark::kMillisecond);
+    benchmark::RegisterBenchmark(("lookup_hit" + suffix).c_str(), BM_LookupHit<Map, Keys>) BENCH_SIZES;
+    benchmark::RegisterBenchmark(("lookup_miss" + suffix).c_str(), BM_LookupMiss<Map, Keys>) BENCH_SIZES;
+    benchmark::RegisterBenchmark(("erase" + suffix).c_str(), BM_Erase<Map, Keys>) BENCH_SIZES->Unit(benchmark::kMillisecond);
+}
+
+template <typename K, typename Keys>
+static void registerTables(){
+    registerOperations<HashTableMap<K>, Keys>();
+    registerOperations<StdMap<K>, Keys>();
+}
+
+template <typename Hash, typename Keys>
+static void registerQuality(){
+    std::string name = std::string("hash_quality/") + Hash::kName + "/" + Keys::kName;
+    // Only the two smaller sizes: char_sum crams every key into a few
+    // hundred buckets, so building its table is quadratic.
+    benchmark::internal::Benchmark* bench = benchmark::RegisterBenchmark(name.c_str(), BM_HashQuality<Hash, Keys>);
+    bench->Arg(1000)->Arg(100000)->Iterations(1)->Unit(benchmark::kMillisecond);
+}
+
+int main(int argc, char** argv){
+    registerTables<std::string, SequentialStrings>();
+    registerTables<std::string, RandomStrings<8> >();
+    registerTables<std::string, RandomStrings<32> >();
+    registerTables<std::string, RandomStrings<128> >();
+    registerTables<uint64_t, SequentialInts>();
+    registerTables<uint64_t, StridedInts>();
+
+    registerQuality<WyHashNamed, SequentialStrings>();
+    registerQuality<WyHashNamed, RandomStrings<32> >();
+    registerQuality<StdHash<std::string>, SequentialStrings>();
+    registerQuality<StdHash<std::string>, RandomStrings<32> >();
+    registerQuality<CharSumHash, SequentialStrings>();
+    registerQuality<CharSumHash, RandomStrings<32> >();
+    registerQuality<DefaultHashNamed<uint64_t>, SequentialInts>();
+    registerQuality<DefaultHashNamed<uint64_t>, StridedInts>();
+    registerQuality<StdHash<uint64_t>, SequentialInts>();
+    registerQuality<StdHash<uint64_t>, StridedInts>();
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)){
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,302 @@
+#ifndef SNAPSHOT_HASHTABLE_H
+#define SNAPSHOT_HASHTABLE_H
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "hashtable.hpp"
+
+// A read-only string-to-string table stored in a file and queried through
+// mmap, so opening even a very large table costs one mmap call: pages are
+// read from disk (or found in the page cache) only when a lookup touches
+// them. The file uses the same control bytes, groups and probe order as
+// HashTable, and everything inside it is an offset from the start of the
+// file, so it works wherever it is mapped.
+//
+// Layout, in native byte order:
+//   Header          64 bytes
+//   control bytes   one per slot, empty or a 7-bit hash tag (no tombstones)
+//   Slot array      16 bytes per slot
+//   data            each key's bytes followed by its value's bytes
+//
+// Write a snapshot from any table with forEach(f(key, value)) whose keys
+// and values convert to std::string_view (HashTable<std::string, ...>,
+// ArenaHashTable), then open it with HashTableSnapshot.
+class HashTableSnapshot {
+    private:
+        static constexpr char kMagic[8] = {'H', 'T', 'S', 'N', 'A', 'P', '1', '\0'};
+        static constexpr std::string_view kHashCheck = "HashTableSnapshot";
+
+        struct Header {
+            char magic[8];
+            uint64_t hashCheck;      // WyHash of kHashCheck; catches a changed hash
+            uint64_t capacity;       // Slots: a power of two, a multiple of 16
+            uint64_t count;
+            uint64_t controlOffset;
+            uint64_t slotsOffset;
+            uint64_t dataOffset;
+            uint64_t fileSize;
+        };
+
+        struct Slot {
+            uint64_t offset;         // Of the key, from the start of data
+            uint32_t keyLength;
+            uint32_t valueLength;
+        };
+
+        static_assert(sizeof(Header) == 64, "Header layout is part of the file format");
+        static_assert(sizeof(Slot) == 16, "Slot layout is part of the file format");
+
+        // An open file and its mapping, released together.
+        struct Mapping {
+            int fd = -1;
+            char* base = nullptr;
+            std::size_t length = 0;
+
+            Mapping() = default;
+            Mapping(const Mapping&) = delete;
+            Mapping& operator=(const Mapping&) = delete;
+
+            Mapping(Mapping&& other) noexcept { *this = std::move(other); }
+
+            Mapping& operator=(Mapping&& other) noexcept {
+                if (this != &other){
+                    release();
+                    fd = std::exchange(other.fd, -1);
+                    base = std::exchange(other.base, nullptr);
+                    length = std::exchange(other.length, 0);
+                }
+                return *this;
+            }
+
+            ~Mapping(){ release(); }
+
+            void release(){
+                if (base){
+                    munmap(base, length);
+                    base = nullptr;
+                }
+                if (fd >= 0){
+                    close(fd);
+                    fd = -1;
+                }
+            }
+        };
+
+        // Deletes a file that write() gave up on before renaming it.
+        struct PartialFile {
+            const std::string& path;
+            bool keep = false;
+
+            ~PartialFile(){
+                if (!keep){
+                    unlink(path.c_str());
+                }
+            }
+        };
+
+        static std::runtime_error error(const std::string& path, const std::string& what){
+            return std::runtime_error("HashTableSnapshot: " + path + ": " + what);
+        }
+
+        Mapping mapping;
+        const Header* header = nullptr;
+        const int8_t* control = nullptr;
+        const Slot* slots = nullptr;
+        const char* data = nullptr;
+        uint64_t dataSize = 0;
+
+    public:
+        // Maps the snapshot at path. Checks the header but not the entries,
+        // so this takes the same time whatever the size of the file.
+        explicit HashTableSnapshot(const std::string& path){
+            mapping.fd = open(path.c_str(), O_RDONLY);
+            if (mapping.fd < 0){
+                throw error(path, std::strerror(errno));
+            }
+            struct stat info;
+            if (fstat(mapping.fd, &info) != 0){
+                throw error(path, std::strerror(errno));
+            }
+            if ((std::size_t)info.st_size < sizeof(Header)){
+                throw error(path, "too small to be a snapshot");
+            }
+            void* base = mmap(nullptr, info.st_size, PROT_READ, MAP_SHARED, mapping.fd, 0);
+            if (base == MAP_FAILED){
+                throw error(path, std::strerror(errno));
+            }
+            mapping.base = (char*)base;
+            mapping.length = info.st_size;
+            close(std::exchange(mapping.fd, -1));  // The mapping keeps the file open
+
+            header = (const Header*)mapping.base;
+            if (std::memcmp(header->magic, kMagic, sizeof(kMagic)) != 0){
+                throw error(path, "not a snapshot");
+            }
+            if (header->hashCheck != WyHash{}(kHashCheck)){
+                throw error(path, "written with a different hash function");
+            }
+            uint64_t capacity = header->capacity;
+            if (capacity < ControlGroup::kSize || (capacity & (capacity - 1)) != 0
+                || header->count > capacity
+                || header->controlOffset != sizeof(Header)
+                || header->slotsOffset != header->controlOffset + capacity
+                || header->dataOffset != header->slotsOffset + capacity * sizeof(Slot)
+                || header->fileSize != (uint64_t)info.st_size
+                || header->dataOffset > header->fileSize){
+                throw error(path, "corrupt header");
+            }
+            control = (const int8_t*)(mapping.base + header->controlOffset);
+            slots = (const Slot*)(mapping.base + header->slotsOffset);
+            data = mapping.base + header->dataOffset;
+            dataSize = header->fileSize - header->dataOffset;
+            // Lookups jump around the file; reading ahead would only evict
+            // pages that are still useful.
+            madvise(mapping.base, mapping.length, MADV_RANDOM);
+        }
+
+        HashTableSnapshot(HashTableSnapshot&&) = default;
+        HashTableSnapshot& operator=(HashTableSnapshot&&) = default;
+
+        // Writes table to path. The file is built under path + ".tmp" and
+        // renamed over path when complete, so processes that still have the
+        // old snapshot mapped keep reading the old one.
+        template <typename Table>
+        static void write(const std::string& path, const Table& table){
+            uint64_t count = 0, dataSize = 0;
+            table.forEach([&](std::string_view key, std::string_view value){
+                if (key.size() > UINT32_MAX || value.size() > UINT32_MAX){
+                    throw error(path, "key or value larger than 4 GB");
+                }
+                count++;
+                dataSize += key.size() + value.size();
+            });
+
+            // Same limit as HashTable: at most 7/8 of the slots full.
+            uint64_t capacity = ControlGroup::kSize;
+            while (capacity * 7 < count * 8){
+                capacity *= 2;
+            }
+            Header layout;
+            std::memcpy(layout.magic, kMagic, sizeof(kMagic));
+            layout.hashCheck = WyHash{}(kHashCheck);
+            layout.capacity = capacity;
+            layout.count = count;
+            layout.controlOffset = sizeof(Header);
+            layout.slotsOffset = layout.controlOffset + capacity;
+            layout.dataOffset = layout.slotsOffset + capacity * sizeof(Slot);
+            layout.fileSize = layout.dataOffset + dataSize;
+
+            // Filled in place through a writable mapping, so neither the
+            // slots nor the data need to fit in memory at once.
+            std::string temporary = path + ".tmp";
+            Mapping file;
+            file.fd = open(temporary.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+            if (file.fd < 0){
+                throw error(temporary, std::strerror(errno));
+            }
+            PartialFile partial{temporary};
+            if (ftruncate(file.fd, layout.fileSize) != 0){
+                throw error(temporary, std::strerror(errno));
+            }
+            void* base = mmap(nullptr, layout.fileSize, PROT_READ | PROT_WRITE, MAP_SHARED, file.fd, 0);
+            if (base == MAP_FAILED){
+                throw error(temporary, std::strerror(errno));
+            }
+            file.base = (char*)base;
+            file.length = layout.fileSize;
+
+            int8_t* control = (int8_t*)(file.base + layout.controlOffset);
+            Slot* slots = (Slot*)(file.base + layout.slotsOffset);
+            char* data = file.base + layout.dataOffset;
+            std::memset(control, (unsigned char)ControlGroup::kEmpty, capacity);
+
+            uint64_t mask = capacity - 1, offset = 0;
+            table.forEach([&](std::string_view key, std::string_view value){
+                uint64_t hash = WyHash{}(key);
+                uint64_t group = (hash >> 7) & mask & ~(ControlGroup::kSize - 1);
+                uint32_t free;
+                for (uint64_t step = ControlGroup::kSize; !(free = ControlGroup::matchFree(control + group)); step += ControlGroup::kSize){
+                    group = (group + step) & mask;
+                }
+                uint64_t slot = group + __builtin_ctz(free);
+                control[slot] = (int8_t)(hash & 0x7f);
+                slots[slot] = Slot{offset, (uint32_t)key.size(), (uint32_t)value.size()};
+                std::memcpy(data + offset, key.data(), key.size());
+                std::memcpy(data + offset + key.size(), value.data(), value.size());
+                offset += key.size() + value.size();
+            });
+
+            // The header goes in last, so a file cut short by a crash is
+            // never mistaken for a snapshot.
+            std::memcpy(file.base, &layout, sizeof(layout));
+            if (msync(file.base, file.length, MS_SYNC) != 0 || fsync(file.fd) != 0){
+                throw error(temporary, std::strerror(errno));
+            }
+            file.release();
+            if (std::rename(temporary.c_str(), path.c_str()) != 0){
+                throw error(path, std::strerror(errno));
+            }
+            partial.keep = true;
+        }
+
+        // The value for key, pointing into the mapping; valid while the
+        // snapshot is open.
+        std::optional<std::string_view> find(std::string_view key) const {
+            uint64_t hash = WyHash{}(key);
+            int8_t tag = (int8_t)(hash & 0x7f);
+            uint64_t mask = header->capacity - 1;
+            uint64_t group = (hash >> 7) & mask & ~(ControlGroup::kSize - 1);
+            // Every group has been visited after capacity / kSize steps. A
+            // file whose control bytes have no empty slot would otherwise
+            // keep this loop going forever.
+            uint64_t groups = header->capacity / ControlGroup::kSize;
+            for (uint64_t step = ControlGroup::kSize; groups > 0; step += ControlGroup::kSize, groups--){
+                for (uint32_t hits = ControlGroup::match(control + group, tag); hits; hits &= hits - 1){
+                    const Slot& slot = slots[group + __builtin_ctz(hits)];
+                    if (slot.offset > dataSize || dataSize - slot.offset < (uint64_t)slot.keyLength + slot.valueLength){
+                        throw std::runtime_error("HashTableSnapshot: entry points outside the file");
+                    }
+                    const char* text = data + slot.offset;
+                    if (slot.keyLength == key.size() && std::memcmp(text, key.data(), key.size()) == 0){
+                        return std::string_view(text + slot.keyLength, slot.valueLength);
+                    }
+                }
+                if (ControlGroup::match(control + group, ControlGroup::kEmpty)){
+                    return std::nullopt;
+                }
+                group = (group + step) & mask;
+            }
+            throw std::runtime_error("HashTableSnapshot: corrupt control bytes, no empty slot");
+        }
+
+        bool contains(std::string_view key) const { return find(key).has_value(); }
+
+        // Calls f(string_view key, string_view value) for every entry, e.g.
+        // to load the snapshot back into a HashTable for editing.
+        template <typename F>
+        void forEach(F&& f) const {
+            for (uint64_t i = 0; i < header->capacity; i++){
+                if (control[i] >= 0){
+                    const char* text = data + slots[i].offset;
+                    f(std::string_view(text, slots[i].keyLength),
+                      std::string_view(text + slots[i].keyLength, slots[i].valueLength));
+                }
+            }
+        }
+
+        std::size_t size() const { return header->count; }
+        std::size_t fileSize() const { return mapping.length; }
+};
+
+#endif
@@ -0,0 +1,72 @@
+CREATE TABLE b (id INT, k INT BLOOM, f FLOAT NULL BLOOM, name STRING BLOOM);
+INSERT INTO b VALUES (0, 43445, NULL, 'user43445');
+INSERT INTO b VALUES (1, 20772, 207.7, 'user20772');
+INSERT INTO b VALUES (2, 52750, 527.5, 'user52750');
+INSERT INTO b VALUES (3, 86319, 863.2, 'user86319');
+INSERT INTO b VALUES (4, 7328, 73.3, 'user7328');
+INSERT INTO b VALUES (5, 10494, NULL, 'user10494');
+INSERT INTO b VALUES (6, 71239, 712.4, 'user71239');
+INSERT INTO b VALUES (7, 13337, 133.4, 'user13337');
+INSERT INTO b VALUES (8, 48931, 489.3, 'user48931');
+INSERT INTO b VALUES (9, 77387, 773.9, 'user77387');
+INSERT INTO b VALUES (10, 8602, NULL, 'user8602');
+INSERT INTO b VALUES (11, 67510, 675.1, 'user67510');
+INSERT INTO b VALUES (12, 29140, 291.4, 'user29140');
+INSERT INTO b VALUES (13, 5914, 59.1, 'user5914');
+INSERT INTO b VALUES (14, 12265, 122.7, 'user12265');
+INSERT INTO b VALUES (15, 57838, NULL, 'user57838');
+INSERT INTO b VALUES (16, 55810, 558.1, 'user55810');
+INSERT INTO b VALUES (17, 10156, 101.6, 'user10156');
+INSERT INTO b VALUES (18, 32544, 325.4, 'user32544');
+INSERT INTO b VALUES (19, 12889, 128.9, 'user12889');
+INSERT INTO b VALUES (20, 73226, NULL, 'user73226');
+INSERT INTO b VALUES (21, 56642, 566.4, 'user56642');
+INSERT INTO b VALUES (22, 8747, 87.5, 'user8747');
+INSERT INTO b VALUES (23, 75115, 751.1, 'user75115');
+INSERT INTO b VALUES (24, 17226, 172.3, 'user17226');
+INSERT INTO b VALUES (25, 30260, NULL, 'user30260');
+INSERT INTO b VALUES (26, 83657, 836.6, 'user83657');
+INSERT INTO b VALUES (27, 83238, 832.4, 'user83238');
+INSERT INTO b VALUES (28, 77414, 774.1, 'user77414');
+INSERT INTO b VALUES (29, 9108, 91.1, 'user9108');
+INSERT INTO b VALUES (30, 76642, NULL, 'user76642');
+INSERT INTO b VALUES (31, 77748, 777.5, 'user77748');
+INSERT INTO b VALUES (32, 52993, 529.9, 'user52993');
+INSERT INTO b VALUES (33, 7499, 75.0, 'user7499');
+INSERT INTO b VALUES (34, 29977, 299.8, 'user29977');
+INSERT INTO b VALUES (35, 7105, NULL, 'user7105');
+INSERT INTO b VALUES (36, 73963, 739.6, 'user73963');
+INSERT INTO b VALUES (37, 18455, 184.6, 'user18455');
+INSERT INTO b VALUES (38, 38959, 389.6, 'user38959');
+INSERT INTO b VALUES (39, 55937, 559.4, 'user55937');
+INSERT INTO b VALUES (40, 19907, NULL, 'user19907');
+INSERT INTO b VALUES (41, 71868, 718.7, 'user71868');
+INSERT INTO b VALUES (42, 16439, 164.4, 'user16439');
+INSERT INTO b VALUES (43, 75830, 758.3, 'user75830');
+INSERT INTO b VALUES (44, 41433, 414.3, 'user41433');
+INSERT INTO b VALUES (45, 74434, NULL, 'user74434');
+INSERT INTO b VALUES (46, 90391, 903.9, 'user90391');
+INSERT INTO b VALUES (47, 24688, 246.9, 'user24688');
+INSERT INTO b VALUES (48, 14507, 145.1, 'user14507');
+INSERT INTO b VALUES (49, 77231, 772.3, 'user77231');
+INSERT INTO b VALUES (50, 75868, NULL, 'user75868');
+INSERT INTO b VALUES (51, 84743, 847.4, 'user84743');
+INSERT INTO b VALUES (52, 25624, 256.2, 'user25624');
+INSERT INTO b VALUES (53, 49810, 498.1, 'user49810');
+INSERT INTO b VALUES (54, 13770, 137.7, 'user13770');
+INSERT INTO b VALUES (55, 72793, NULL, 'user72793');
+INSERT INTO b VALUES (56, 94337, 943.4, 'user94337');
+INSERT INTO b VALUES (57, 9229, 92.3, 'user9229');
+INSERT INTO b VALUES (58, 74972, 749.7, 'user74972');
+INSERT INTO b VALUES (59, 8812, 88.1, 'user8812');
+INSERT INTO b VALUES (60, 86319, 1.1, 'user86319');
+.stats reset
+SELECT * FROM b WHERE k = 86319;
+SELECT * FROM b WHERE k = 19907;
+SELECT * FROM b WHERE k = 7;
+SELECT * FROM b WHERE name = 'user75868';
+SELECT * FROM b WHERE name = 'nobody';
+SELECT * FROM b WHERE f = 1.1;
+SELECT * FROM b WHERE f = 133.4;
+SELECT * FROM b WHERE f IS NULL;
+.stats
@@ -0,0 +1,5 @@
+SELECT * FROM t;
+SELECT * FROM u;
+INSERT INTO t VALUES (4, 'after4');
+SELECT * FROM t WHERE id > 2;
+CREATE TABLE u (id INT);
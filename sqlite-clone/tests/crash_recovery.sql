@@ -0,0 +1,47 @@
+CREATE TABLE t (id INT, name STRING);
+INSERT INTO t VALUES (1, 'before1');
+INSERT INTO t VALUES (2, 'before2');
+INSERT INTO t VALUES (3, 'before3');
+BEGIN;
+CREATE TABLE u (id INT);
+INSERT INTO u VALUES (1);
+INSERT INTO t VALUES (4, 'during4');
+INSERT INTO t VALUES (5, 'during5');
+INSERT INTO t VALUES (6, 'during6');
+INSERT INTO t VALUES (7, 'during7');
+INSERT INTO t VALUES (8, 'during8');
+INSERT INTO t VALUES (9, 'during9');
+INSERT INTO t VALUES (10, 'during10');
+INSERT INTO t VALUES (11, 'during11');
+INSERT INTO t VALUES (12, 'during12');
+INSERT INTO t VALUES (13, 'during13');
+INSERT INTO t VALUES (14, 'during14');
+INSERT INTO t VALUES (15, 'during15');
+INSERT INTO t VALUES (16, 'during16');
+INSERT INTO t VALUES (17, 'during17');
+INSERT INTO t VALUES (18, 'during18');
+INSERT INTO t VALUES (19, 'during19');
+INSERT INTO t VALUES (20, 'during20');
+INSERT INTO t VALUES (21, 'during21');
+INSERT INTO t VALUES (22, 'during22');
+INSERT INTO t VALUES (23, 'during23');
+INSERT INTO t VALUES (24, 'during24');
+INSERT INTO t VALUES (25, 'during25');
+INSERT INTO t VALUES (26, 'during26');
+INSERT INTO t VALUES (27, 'during27');
+INSERT INTO t VALUES (28, 'during28');
+INSERT INTO t VALUES (29, 'during29');
+INSERT INTO t VALUES (30, 'during30');
+INSERT INTO t VALUES (31, 'during31');
+INSERT INTO t VALUES (32, 'during32');
+INSERT INTO t VALUES (33, 'during33');
+INSERT INTO t VALUES (34, 'during34');
+INSERT INTO t VALUES (35, 'during35');
+INSERT INTO t VALUES (36, 'during36');
+INSERT INTO t VALUES (37, 'during37');
+INSERT INTO t VALUES (38, 'during38');
+INSERT INTO t VALUES (39, 'during39');
+INSERT INTO t VALUES (40, 'during40');
+SELECT * FROM t WHERE id > 38;
+COMMIT;
+SELECT * FROM t;
@@ -0,0 +1,71 @@
+CREATE TABLE s (id INT, name STRING);
+INSERT INTO s VALUES (1, 'apple');
+INSERT INTO s VALUES (2, 'apricot');
+INSERT INTO s VALUES (3, 'banana');
+INSERT INTO s VALUES (4, 'a%xc');
+INSERT INTO s VALUES (5, 'abc');
+INSERT INTO s VALUES (6, 'a_c');
+INSERT INTO s VALUES (7, 'Apple pie');
+INSERT INTO s VALUES (8, '');
+INSERT INTO s VALUES (9, '100%');
+INSERT INTO s VALUES (10, 'back\slash');
+INSERT INTO s VALUES (11, 'log 11 ok');
+INSERT INTO s VALUES (12, 'log 12 ok');
+INSERT INTO s VALUES (13, 'log 13 ERROR disk');
+INSERT INTO s VALUES (14, 'log 14 ok');
+INSERT INTO s VALUES (15, 'log 15 ok');
+INSERT INTO s VALUES (16, 'log 16 ok');
+INSERT INTO s VALUES (17, 'log 17 ok');
+INSERT INTO s VALUES (18, 'log 18 ok');
+INSERT INTO s VALUES (19, 'log 19 ok');
+INSERT INTO s VALUES (20, 'log 20 ok');
+INSERT INTO s VALUES (21, 'log 21 ok');
+INSERT INTO s VALUES (22, 'log 22 ok');
+INSERT INTO s VALUES (23, 'log 23 ok');
+INSERT INTO s VALUES (24, 'log 24 ok');
+INSERT INTO s VALUES (25, 'log 25 ok');
+INSERT INTO s VALUES (26, 'log 26 ERROR disk');
+INSERT INTO s VALUES (27, 'log 27 ok');
+INSERT INTO s VALUES (28, 'log 28 ok');
+INSERT INTO s VALUES (29, 'log 29 ok');
+INSERT INTO s VALUES (30, 'log 30 ok');
+INSERT INTO s VALUES (31, 'log 31 ok');
+INSERT INTO s VALUES (32, 'log 32 ok');
+INSERT INTO s VALUES (33, 'log 33 ok');
+INSERT INTO s VALUES (34, 'log 34 ok');
+INSERT INTO s VALUES (35, 'log 35 ok');
+INSERT INTO s VALUES (36, 'log 36 ok');
+INSERT INTO s VALUES (37, 'log 37 ok');
+INSERT INTO s VALUES (38, 'log 38 ok');
+INSERT INTO s VALUES (39, 'log 39 ERROR disk');
+INSERT INTO s VALUES (40, 'log 40 ok');
+INSERT INTO s VALUES (41, 'log 41 ok');
+INSERT INTO s VALUES (42, 'log 42 ok');
+INSERT INTO s VALUES (43, 'log 43 ok');
+INSERT INTO s VALUES (44, 'log 44 ok');
+INSERT INTO s VALUES (45, 'log 45 ok');
+INSERT INTO s VALUES (46, 'log 46 ok');
+INSERT INTO s VALUES (47, 'log 47 ok');
+INSERT INTO s VALUES (48, 'log 48 ok');
+INSERT INTO s VALUES (49, 'log 49 ok');
+INSERT INTO s VALUES (50, 'log 50 ok');
+SELECT * FROM s WHERE name LIKE 'ap%';
+SELECT * FROM s WHERE name LIKE '%ana';
+SELECT * FROM s WHERE name LIKE '%pp%';
+SELECT * FROM s WHERE name LIKE 'a%c';
+SELECT * FROM s WHERE name LIKE 'a_c';
+SELECT * FROM s WHERE name LIKE 'apple';
+SELECT * FROM s WHERE name LIKE 'Apple%';
+SELECT * FROM s WHERE name LIKE '_';
+SELECT * FROM s WHERE name LIKE '%a%a%a%';
+SELECT * FROM s WHERE name LIKE '';
+SELECT * FROM s WHERE name LIKE 'a\%%';
+SELECT * FROM s WHERE name LIKE 'a\_c';
+SELECT * FROM s WHERE name LIKE '%\%';
+SELECT * FROM s WHERE name LIKE '100\%';
+SELECT * FROM s WHERE name LIKE '%\\%';
+SELECT * FROM s WHERE name LIKE 'back\slash';
+SELECT * FROM s WHERE name LIKE '%ERROR%';
+SELECT * FROM s WHERE name LIKE '%ERROR d_sk';
+SELECT * FROM s WHERE name = '';
+SELECT * FROM s WHERE id LIKE '1';
@@ -0,0 +1,34 @@
+CREATE TABLE l (i INT, f FLOAT, b BOOL, s STRING);
+INSERT INTO l VALUES (1, 1.5, true, 'a');
+INSERT INTO l VALUES (+2, +2.5, false, 'b');
+INSERT INTO l VALUES (-3, -3.5, TRUE, 'c');
+INSERT INTO l VALUES (2147483647, 1e38, FALSE, 'max');
+INSERT INTO l VALUES (-2147483648, -1e-3, true, 'min');
+INSERT INTO l VALUES (  4  ,  4.25 , true ,  'spaced'  );
+INSERT INTO l VALUES (5, 5, true, 'with, comma');
+INSERT INTO l VALUES (+-6, 1.0, true, 'x');
+INSERT INTO l VALUES (++6, 1.0, true, 'x');
+INSERT INTO l VALUES (-+6, 1.0, true, 'x');
+INSERT INTO l VALUES (2147483648, 1.0, true, 'x');
+INSERT INTO l VALUES (6x, 1.0, true, 'x');
+INSERT INTO l VALUES (, 1.0, true, 'x');
+INSERT INTO l VALUES (6, +-1.0, true, 'x');
+INSERT INTO l VALUES (6, inf, true, 'x');
+INSERT INTO l VALUES (6, nan, true, 'x');
+INSERT INTO l VALUES (6, 1e39, true, 'x');
+INSERT INTO l VALUES (6, 1.0.0, true, 'x');
+INSERT INTO l VALUES (6, 1.0, yes, 'x');
+INSERT INTO l VALUES (6, 1.0, true);
+INSERT INTO l VALUES (6, 1.0, true, 'x', 7);
+SELECT * FROM l;
+SELECT * FROM l WHERE i = +2;
+SELECT * FROM l WHERE i = +-2;
+SELECT * FROM l WHERE i > -4;
+SELECT * FROM l WHERE f = 4.25;
+SELECT * FROM l WHERE f < inf;
+SELECT * FROM l WHERE f = nan;
+SELECT * FROM l WHERE f > 1e300;
+SELECT * FROM l WHERE i = 1.5;
+SELECT * FROM l WHERE b = true;
+SELECT * FROM l WHERE s = 'with, comma';
+INSERT INTO l VALUES (6, 1.0, true, 'unterminated);
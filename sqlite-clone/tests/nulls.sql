@@ -0,0 +1,15 @@
+CREATE TABLE n (id INT, note STRING NULL, score FLOAT NULL, tag STRING);
+INSERT INTO n VALUES (1, 'NULL', 1.5, 'x');
+INSERT INTO n VALUES (2, 'bob', NULL, 'NULL');
+INSERT INTO n VALUES (3, NULL, 2.5, 'y');
+INSERT INTO n VALUES (4, null, NULL, 'z');
+INSERT INTO n VALUES (5, 'ann', 3.5, 'w');
+INSERT INTO n VALUES (6, 'eve', 4.5, NULL);
+SELECT * FROM n;
+SELECT * FROM n WHERE note IS NULL;
+SELECT * FROM n WHERE note IS NOT NULL;
+SELECT * FROM n WHERE note = 'NULL';
+SELECT * FROM n WHERE tag = 'NULL';
+SELECT * FROM n WHERE score IS NULL;
+SELECT * FROM n WHERE score > 2;
+SELECT * FROM n WHERE score != 1.5;
@@ -0,0 +1,35 @@
+#!/bin/sh
+# Runs tests/NAME.sql through `.read` against a new database and compares
+# what it prints with tests/NAME.expected. Prompts are dropped and timings
+# replaced with N, so the output only changes when behaviour does.
+#
+# When tests/NAME.after.sql exists, the first run crashes: it stops in its
+# first COMMIT, after the pages are written but before the journal is
+# cleared (or at end of input, without `.exit`). A second run then reads
+# NAME.after.sql from the same file.
+#
+#   run_test.sh path/to/simple_db path/to/tests/NAME.sql
+simple_db=$1
+script=$2
+name=${script%.sql}
+dir=$(mktemp -d) || exit 1
+trap 'rm -rf "$dir"' EXIT
+
+run() {
+    if [ "$2" = exit ]; then
+        printf '.read %s\n.exit\n' "$1" | "$simple_db" "$dir/test.db"
+    else
+        printf '.read %s\n' "$1" | SIMPLE_DB_CRASH_IN_COMMIT=1 "$simple_db" "$dir/test.db"
+    fi
+}
+
+{
+    if [ -f "$name.after.sql" ]; then
+        run "$script" crash
+        run "$name.after.sql" exit
+    else
+        run "$script" exit
+    fi
+} | sed -e 's/db > //g' -e 's/[0-9][0-9]*\.[0-9][0-9]* ms/N ms/' -e 's/ *[0-9][0-9]*\.[0-9][0-9][0-9]$/ N/' >"$dir/actual"
+
+diff -u "$name.expected" "$dir/actual"
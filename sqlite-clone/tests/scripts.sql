@@ -0,0 +1,14 @@
+CREATE TABLE m (id INT, s STRING);
+INSERT INTO m
+    VALUES (1, 'one');
+INSERT INTO m VALUES (2, 'two
+  indented;
+line'); INSERT INTO m VALUES (3,
+'three');
+.stats reset
+SELECT * FROM m WHERE s LIKE '%
+  ind%';
+SELECT *
+FROM m
+WHERE id >= 2;
+SELECT * FROM m WHERE id = 1
@@ -0,0 +1,24 @@
+CREATE TABLE t (id INT, name STRING);
+INSERT INTO t VALUES (1, 'one');
+COMMIT;
+ROLLBACK;
+BEGIN;
+BEGIN;
+INSERT INTO t VALUES (2, 'two');
+SELECT * FROM t;
+ROLLBACK;
+SELECT * FROM t;
+BEGIN;
+INSERT INTO t VALUES (3, 'three');
+COMMIT;
+SELECT * FROM t;
+BEGIN;
+CREATE TABLE u (id INT);
+INSERT INTO u VALUES (1);
+VACUUM;
+ROLLBACK;
+SELECT * FROM u;
+INSERT INTO u VALUES (2);
+CREATE TABLE u (id INT);
+INSERT INTO u VALUES (3);
+SELECT * FROM u;
@@ -0,0 +1,69 @@
+CREATE TABLE z (id INT, score FLOAT, active BOOL, pad STRING);
+INSERT INTO z VALUES (1, 0.1, true, 'row1');
+INSERT INTO z VALUES (2, 0.2, false, 'row2');
+INSERT INTO z VALUES (3, 0.3, true, 'row3');
+INSERT INTO z VALUES (4, 0.4, false, 'row4');
+INSERT INTO z VALUES (5, 0.5, true, 'row5');
+INSERT INTO z VALUES (6, 0.6, false, 'row6');
+INSERT INTO z VALUES (7, 0.7, true, 'row7');
+INSERT INTO z VALUES (8, 0.8, false, 'row8');
+INSERT INTO z VALUES (9, 0.9, true, 'row9');
+INSERT INTO z VALUES (10, 1.0, false, 'row10');
+INSERT INTO z VALUES (11, 1.1, true, 'row11');
+INSERT INTO z VALUES (12, 1.2, false, 'row12');
+INSERT INTO z VALUES (13, 1.3, true, 'row13');
+INSERT INTO z VALUES (14, 1.4, false, 'row14');
+INSERT INTO z VALUES (15, 1.5, true, 'row15');
+INSERT INTO z VALUES (16, 1.6, false, 'row16');
+INSERT INTO z VALUES (17, 1.7, true, 'row17');
+INSERT INTO z VALUES (18, 1.8, false, 'row18');
+INSERT INTO z VALUES (19, 1.9, true, 'row19');
+INSERT INTO z VALUES (20, 2.0, false, 'row20');
+INSERT INTO z VALUES (21, 2.1, true, 'row21');
+INSERT INTO z VALUES (22, 2.2, false, 'row22');
+INSERT INTO z VALUES (23, 2.3, true, 'row23');
+INSERT INTO z VALUES (24, 2.4, false, 'row24');
+INSERT INTO z VALUES (25, 2.5, true, 'row25');
+INSERT INTO z VALUES (26, 2.6, false, 'row26');
+INSERT INTO z VALUES (27, 2.7, true, 'row27');
+INSERT INTO z VALUES (28, 2.8, false, 'row28');
+INSERT INTO z VALUES (29, 2.9, true, 'row29');
+INSERT INTO z VALUES (30, 3.0, false, 'row30');
+INSERT INTO z VALUES (31, 3.1, true, 'row31');
+INSERT INTO z VALUES (32, 3.2, false, 'row32');
+INSERT INTO z VALUES (33, 3.3, true, 'row33');
+INSERT INTO z VALUES (34, 3.4, false, 'row34');
+INSERT INTO z VALUES (35, 3.5, true, 'row35');
+INSERT INTO z VALUES (36, 3.6, false, 'row36');
+INSERT INTO z VALUES (37, 3.7, true, 'row37');
+INSERT INTO z VALUES (38, 3.8, false, 'row38');
+INSERT INTO z VALUES (39, 3.9, true, 'row39');
+INSERT INTO z VALUES (40, 4.0, false, 'row40');
+INSERT INTO z VALUES (41, 4.1, true, 'row41');
+INSERT INTO z VALUES (42, 4.2, false, 'row42');
+INSERT INTO z VALUES (43, 4.3, true, 'row43');
+INSERT INTO z VALUES (44, 4.4, false, 'row44');
+INSERT INTO z VALUES (45, 4.5, true, 'row45');
+INSERT INTO z VALUES (46, 4.6, false, 'row46');
+INSERT INTO z VALUES (47, 4.7, true, 'row47');
+INSERT INTO z VALUES (48, 4.8, false, 'row48');
+INSERT INTO z VALUES (49, 4.9, true, 'row49');
+INSERT INTO z VALUES (50, 5.0, false, 'row50');
+INSERT INTO z VALUES (51, 5.1, true, 'row51');
+INSERT INTO z VALUES (52, 5.2, false, 'row52');
+INSERT INTO z VALUES (53, 5.3, true, 'row53');
+INSERT INTO z VALUES (54, 5.4, false, 'row54');
+INSERT INTO z VALUES (55, 5.5, true, 'row55');
+INSERT INTO z VALUES (56, 5.6, false, 'row56');
+INSERT INTO z VALUES (57, 5.7, true, 'row57');
+INSERT INTO z VALUES (58, 5.8, false, 'row58');
+INSERT INTO z VALUES (59, 5.9, true, 'row59');
+INSERT INTO z VALUES (60, 6.0, false, 'row60');
+.stats reset
+SELECT * FROM z WHERE id < 3;
+SELECT * FROM z WHERE id >= 59;
+SELECT * FROM z WHERE id = 31;
+SELECT * FROM z WHERE id > 60;
+SELECT * FROM z WHERE score = 1.1;
+SELECT * FROM z WHERE score > 5.85;
+.stats